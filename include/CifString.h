@@ -139,11 +139,110 @@ public:
     static void GetCategoryFromCifItem(std::string& categoryName,
       const std::string& itemName);
 
+    // Non-allocating split. On success, the category name is
+    // cifItem[1, dotIndex) and the item name is cifItem[dotIndex + 1, end).
+    // Returns false, instead of throwing, for a CIF item without a non-empty
+    // category and item name.
+    static bool SplitCifItem(std::string::size_type& dotIndex,
+      const std::string& cifItem);
+
+    static bool IsCifItemOfCategory(const std::string& cifItem,
+      const std::string& categoryName);
+
     static bool IsEmptyValue(const std::string& value);
     static bool IsUnknownValue(const std::string& value);
 
     static bool IsSpecialChar(const char charValue);
     static bool IsSpecialFirstChar(const char charValue);
+
+    // Classes of the values of a column. Element i of each bitmap
+    // describes value i. Counts are the numbers of set bits.
+    struct tValueClasses
+    {
+        std::vector<bool> null;         // IsEmptyValue()
+        std::vector<bool> unknown;      // IsUnknownValue()
+        std::vector<bool> needsQuoting; // Not null and cannot be written bare
+        std::vector<bool> whiteSpace;   // Contains white space
+        std::vector<bool> newLine;      // Contains a line break
+        std::vector<bool> numeric;      // CIF number, e.g. -1.5e3 or 1.23(4)
+
+        unsigned int numNull;
+        unsigned int numUnknown;
+        unsigned int numNeedsQuoting;
+        unsigned int numWhiteSpace;
+        unsigned int numNewLine;
+        unsigned int numNumeric;
+    };
+
+    // Classifies all values in one pass, scanning the characters 16 or 32
+    // at a time, when the compiler targets SSE2 or AVX2.
+    static void ClassifyValues(tValueClasses& classes,
+      const std::vector<std::string>& values);
+
+    static bool IsNumericValue(const std::string& value);
+    static bool IsReservedWord(const std::string& value);
+
+  private:
+    static unsigned int GetCharClasses(const char* chars,
+      const unsigned int len);
+};
+
+
+/**
+ ** \class CifItemInterner
+ **
+ ** \brief Maps CIF item names to dense, stable integer IDs.
+ **
+ ** IDs start at 0 and are assigned in the order in which the items are
+ ** first interned. Once an item has an ID, it keeps it until Clear(), so
+ ** that hot paths can compare and hash IDs instead of strings. Items can be
+ ** looked up by the full CIF item name, or by category and attribute names
+ ** without composing the CIF item. Names are case-sensitive, unless the
+ ** interner is created as case-insensitive, in which case the first
+ ** spelling is kept.
+ */
+class CifItemInterner
+{
+  public:
+    CifItemInterner(const bool caseSensitive = true);
+    ~CifItemInterner();
+
+    unsigned int Intern(const std::string& cifItem);
+    unsigned int Intern(const std::string& categoryName,
+      const std::string& attribName);
+
+    /// When not found, returns GetSize()
+    unsigned int Find(const std::string& cifItem) const;
+    unsigned int Find(const std::string& categoryName,
+      const std::string& attribName) const;
+
+    const std::string& GetCifItem(const unsigned int id) const;
+
+    unsigned int GetSize() const;
+    void Clear();
+
+  private:
+    bool _caseSensitive;
+
+    // Items and their hashes, by ID
+    std::vector<std::string> _cifItems;
+    std::vector<unsigned int> _hashes;
+
+    // Open addressing table of IDs plus one. Zero is a free slot.
+    std::vector<unsigned int> _slots;
+
+    unsigned int Hash(const std::string& categoryName,
+      const std::string& attribName) const;
+    unsigned int HashPart(unsigned int hash, const char* beg,
+      const char* end) const;
+    bool IsEqualPart(const char* beg1, const char* beg2,
+      const unsigned int len) const;
+    bool IsEqual(const std::string& cifItem, const std::string& categoryName,
+      const std::string& attribName) const;
+
+    unsigned int FindPos(const std::string& categoryName,
+      const std::string& attribName, const unsigned int hash) const;
+    void Grow();
 };
 
 #endif
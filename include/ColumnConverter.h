@@ -0,0 +1,116 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file ColumnConverter.h
+**
+** Typed column and column conversion classes.
+*/
+
+
+#ifndef COLUMNCONVERTER_H
+#define COLUMNCONVERTER_H
+
+
+#include <string>
+#include <vector>
+
+#include "rcsb_types.h"
+
+
+/**
+ ** \class TypedColumn
+ **
+ ** \brief Column of values of one type, converted from CIF strings.
+ **
+ ** Integer columns hold SInt64 values, float columns hold double values and
+ ** date columns hold yyyymmdd SInt32 values. Text columns hold pointers to
+ ** the source strings, which must outlive the column. Only the array of
+ ** the column type is filled. Validity is a bitmap with one bit per row
+ ** (bit (row % 32) of word (row / 32)), which is set when the row has a
+ ** value. Unknown ("?"), inapplicable (".") and empty values are not
+ ** valid, and neither are values that cannot be converted, which are also
+ ** counted as errors.
+ */
+class TypedColumn
+{
+  public:
+    TypedColumn();
+    ~TypedColumn();
+
+    eTypeCode GetType() const;
+    unsigned int GetNumRows() const;
+
+    /// Number of values that could not be converted to the type
+    unsigned int GetNumErrors() const;
+
+    inline bool IsValid(const unsigned int row) const;
+    const std::vector<UInt32>& GetValidity() const;
+
+    const std::vector<SInt64>& GetInts() const;
+    const std::vector<double>& GetDoubles() const;
+    const std::vector<SInt32>& GetDates() const;
+    const std::vector<const std::string*>& GetTexts() const;
+
+  private:
+    friend class ColumnConverter;
+
+    eTypeCode _type;
+    unsigned int _numRows;
+    unsigned int _numErrors;
+
+    std::vector<UInt32> _validity;
+
+    std::vector<SInt64> _ints;
+    std::vector<double> _doubles;
+    std::vector<SInt32> _dates;
+    std::vector<const std::string*> _texts;
+};
+
+
+/**
+ ** \class ColumnConverter
+ **
+ ** \brief Converts a category's string columns into typed columns.
+ **
+ ** The column types are the eTypeCode values of DataInfo::GetItemsTypes().
+ ** Integer (including big integer), float (including scientific) and date
+ ** columns are converted, all other columns are kept as text. The work is
+ ** split into tasks of one column and a range of rows, which run on
+ ** multiple threads.
+ */
+class ColumnConverter
+{
+  public:
+    static void Convert(std::vector<TypedColumn>& outColumns,
+      const std::vector<const std::vector<std::string>*>& columns,
+      const std::vector<eTypeCode>& types,
+      const unsigned int numThreads = 0);
+
+    // Converts a "yyyy-mm-dd" date, optionally followed by a time that
+    // starts with ':', 'T' or ' ', to a yyyymmdd value. The day must exist
+    // in the month, with Gregorian leap years.
+    static bool ParseDate(SInt32& date, const std::string& value);
+
+  private:
+    ColumnConverter();
+    ~ColumnConverter();
+
+    static void ConvertTasks(void* arg, const unsigned int chunk,
+      const unsigned int beg, const unsigned int end);
+    static void ConvertRows(TypedColumn& outColumn,
+      const std::vector<std::string>& column, const unsigned int beg,
+      const unsigned int end, unsigned int& numErrors);
+};
+
+
+inline bool TypedColumn::IsValid(const unsigned int row) const
+{
+    return ((_validity[row / 32] >> (row % 32)) & 1);
+}
+
+
+#endif
@@ -17,15 +17,97 @@
 
 #include <string>
 #include <vector>
+#include <map>
+#include <set>
 #include <iostream>
 
 #include "rcsb_types.h"
 #include "GenString.h"
+#include "GenCont.h"
+#include "CifString.h"
+
+
+/**
+ ** \class DataInfoProfiler
+ **
+ ** \brief Statistics of the dictionary queries made by DataInfo.
+ **
+ ** Calls and time are summed per query kind, category and attribute. For
+ ** attribute queries, these are the referenced DDL category and attribute,
+ ** e.g., item_type and code. For key queries, the category is the queried
+ ** one, and for item queries, the category and attribute of the queried
+ ** item. A call is a repeat if the same query was made before with the
+ ** same arguments. Queries with many repeats benefit from memoization.
+ ** The profiler is not thread-safe.
+ */
+class DataInfoProfiler
+{
+  public:
+    enum eQuery
+    {
+        eQUERY_ITEM_ATTRIBUTE = 0,
+        eQUERY_CAT_ATTRIBUTE,
+        eQUERY_CAT_KEYS,
+        eQUERY_ITEM_DEFINED
+    };
+
+    struct tStats
+    {
+        eQuery query;
+        std::string catName;
+        std::string attribName;
+        UInt64 numCalls;
+        UInt64 numRepeats;
+        double seconds;
+    };
+
+    DataInfoProfiler();
+    ~DataInfoProfiler();
+
+    void Clear();
+
+    void Record(const eQuery query, const std::string& catName,
+      const std::string& attribName, const std::string& name,
+      const double seconds);
+
+    /// Statistics, by decreasing time
+    void GetStats(std::vector<tStats>& stats) const;
+
+    /// Writes the topN entries with the most time, and which of them
+    /// should be memoized.
+    void Report(std::ostream& out, const unsigned int topN = 20) const;
+
+    static const char* GetQueryName(const eQuery query);
+
+  private:
+    // Statistics, by query, category and attribute
+    std::map<std::string, tStats> _stats;
+
+    // Query and arguments of all the calls so far
+    std::set<std::string> _calls;
+
+    static void MakeKey(std::string& key, const eQuery query,
+      const std::string& catName, const std::string& attribName);
+};
 
 
 class DataInfo
 {
   public:
+    enum eValueError
+    {
+        eVALUE_ERROR_KEY_EMPTY = 1,  // Key item has empty, "?" or "." value
+        eVALUE_ERROR_UNKNOWN,        // Unknown value, where not allowed
+        eVALUE_ERROR_TYPE            // Value does not match the item type
+    };
+
+    struct tValueError
+    {
+        unsigned int row;
+        unsigned int column;
+        eValueError error;
+    };
+
     DataInfo();
     virtual ~DataInfo();
 
@@ -63,10 +145,32 @@ class DataInfo
       const std::vector<std::string>& values,
       const Char::eCompareType compareType = Char::eCASE_SENSITIVE);
 
+    // Column-oriented version of AreItemsValuesValid() for a whole table.
+    // columns[i] holds the values of attribsNames[i] in all rows. The item
+    // rules are resolved once per column, large tables are checked on
+    // multiple threads and all errors are returned, ordered by row and
+    // column, instead of being written to cerr. With checkTypes, values of
+    // integer and float items must also be numbers. An inapplicable
+    // "_atom_sites_alt.id" is also reported in CIF_ITEM, as there.
+    bool AreColumnsValuesValid(std::vector<tValueError>& errors,
+      const std::string& catName,
+      const std::vector<std::string>& attribsNames,
+      const std::vector<const std::vector<std::string>*>& columns,
+      const std::vector<bool>& allowedNullAttribs,
+      const bool checkTypes = false,
+      const Char::eCompareType compareType = Char::eCASE_SENSITIVE,
+      const unsigned int numThreads = 0);
+
     virtual bool IsKeyItem(const std::string& catName,
       const std::string& attribName,
       const Char::eCompareType compareType = Char::eCASE_SENSITIVE);
 
+    // Opt-in profiling of the dictionary queries that DataInfo methods
+    // make. Profiling is off (NULL), by default, which costs one test per
+    // query. The profiler is not owned.
+    void SetProfiler(DataInfoProfiler* profiler);
+    DataInfoProfiler* GetProfiler() const;
+
     virtual bool MustConvertItem(const std::string& catName,
       const std::string& attribName);
 
@@ -77,6 +181,10 @@ class DataInfo
       const std::string& catName,
       const std::string& attribName);
 
+    // Items of the category, in dictionary order
+    const std::vector<std::string>& GetCatItemsNames(
+      const std::string& catName);
+
     void GetMandatoryItems(std::vector<std::string>& mandItemsNames,
       const std::string& catName);
 
@@ -92,6 +200,40 @@ class DataInfo
       GetComboKeys(const std::string& catName);
     std::vector<std::vector<std::vector<std::string> > >&
       GetChildrenKeys(const std::vector<std::string>& parComboKey);
+
+  protected:
+    // Derived classes that change the dictionary after it has been queried
+    // must call this, to drop the information that is cached below.
+    void ClearCaches();
+
+    // Dictionary queries, which are profiled when a profiler is set.
+    // DataInfo methods query the dictionary through these.
+    const std::vector<std::string>& QueryItemAttribute(
+      const std::string& itemName, const std::string& refCatName,
+      const std::string& refAttribName);
+    const std::vector<std::string>& QueryCatAttribute(
+      const std::string& catName, const std::string& refCatName,
+      const std::string& refAttribName);
+    const std::vector<std::string>& QueryCatKeys(const std::string& catName);
+    bool QueryItemDefined(const std::string& itemName);
+
+  private:
+    DataInfoProfiler* _profiler;
+
+    // Lookup sets, built on first use, of the enumerations by CIF item name
+    std::map<std::string, LookupSet> _enumSets;
+
+    // Key items of the categories in _keyCats, interned on first use, so
+    // that key lookups do not compose the CIF item name
+    std::set<std::string> _keyCats;
+    CifItemInterner _keyItems;
+
+    // Items of each category, built on first use for all categories
+    bool _catItemsBuilt;
+    std::map<std::string, std::vector<std::string> > _catItems;
+
+    // Mandatory items, by category name
+    std::map<std::string, std::vector<std::string> > _mandItems;
 };
 
 #ifndef VLAD_ATOM_SITES_ALT_ID_IGNORE
@@ -0,0 +1,153 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file DataSchema.h
+**
+** Compiled dictionary schema class.
+*/
+
+
+#ifndef DATASCHEMA_H
+#define DATASCHEMA_H
+
+
+#include <string>
+#include <vector>
+
+#include "rcsb_types.h"
+#include "GenString.h"
+#include "GenCont.h"
+#include "flat_index.h"
+#include "DataInfo.h"
+
+
+/**
+ ** \class DataSchema
+ **
+ ** \brief Dense, read-only tables of the dictionary information that is
+ ** needed to check data.
+ **
+ ** The schema is compiled once from a DataInfo object, with one query of
+ ** DataInfo per category and item. After that, categories and items are
+ ** identified by dense integer IDs and all item properties (type, key,
+ ** mandatory, unknown value allowed, enumerations and ranges) are looked
+ ** up by ID in constant time, without building CIF item names and without
+ ** virtual calls. Category and item names are looked up case-insensitively.
+ ** The schema does not refer to the DataInfo object after compilation.
+ */
+class DataSchema
+{
+  public:
+    DataSchema();
+    DataSchema(DataInfo& dataInfo);
+
+    ~DataSchema();
+
+    void Compile(DataInfo& dataInfo);
+    void Clear();
+
+    unsigned int GetNumCats() const;
+
+    /// When not found, returns GetNumCats()
+    unsigned int FindCat(const std::string& catName) const;
+
+    const std::string& GetCatName(const unsigned int catId) const;
+
+    unsigned int GetNumItems(const unsigned int catId) const;
+
+    /// When not found, returns GetNumItems(catId)
+    unsigned int FindItem(const unsigned int catId,
+      const std::string& attribName) const;
+
+    const std::string& GetAttribName(const unsigned int catId,
+      const unsigned int itemId) const;
+    const std::string& GetCifItem(const unsigned int catId,
+      const unsigned int itemId) const;
+
+    /// IDs of the category key items
+    const std::vector<unsigned int>& GetKeyItems(
+      const unsigned int catId) const;
+
+    /// IDs of the category mandatory items
+    const std::vector<unsigned int>& GetMandatoryItems(
+      const unsigned int catId) const;
+
+    eTypeCode GetItemType(const unsigned int catId,
+      const unsigned int itemId) const;
+    bool IsKeyItem(const unsigned int catId, const unsigned int itemId) const;
+    bool IsItemMandatory(const unsigned int catId,
+      const unsigned int itemId) const;
+    bool IsUnknownValueAllowed(const unsigned int catId,
+      const unsigned int itemId) const;
+
+    const std::vector<std::string>& GetEnums(const unsigned int catId,
+      const unsigned int itemId) const;
+    void StandardizeEnumItem(std::string& value, const unsigned int catId,
+      const unsigned int itemId) const;
+
+    bool HasRanges(const unsigned int catId, const unsigned int itemId) const;
+
+    /// True if the item has no ranges, or if value is in any of them
+    bool IsInRange(const unsigned int catId, const unsigned int itemId,
+      const double value) const;
+
+  private:
+    // One permissible range. Bounds are exclusive, except that a range
+    // with equal bounds allows exactly that value, as in DDL2.
+    struct tRange
+    {
+        bool hasMin;
+        bool hasMax;
+        double min;
+        double max;
+    };
+
+    // Category tables. Vectors are indexed by item ID.
+    struct tCatInfo
+    {
+        tCatInfo();
+
+        std::string name;
+
+        std::vector<std::string> attribNames;
+        std::vector<std::string> cifItems;
+
+        std::vector<eTypeCode> types;
+        std::vector<bool> keys;
+        std::vector<bool> mandatory;
+        std::vector<bool> unknownAllowed;
+
+        std::vector<unsigned int> keyIds;
+        std::vector<unsigned int> mandatoryIds;
+
+        std::vector<std::vector<std::string> > enums;
+        std::vector<LookupSet> enumSets;
+        std::vector<std::vector<tRange> > ranges;
+
+        flat_index<std::string, unsigned int,
+          StringLessT<Char::eCASE_INSENSITIVE> > itemIndex;
+    };
+
+    std::vector<tCatInfo> _cats;
+
+    flat_index<std::string, unsigned int,
+      StringLessT<Char::eCASE_INSENSITIVE> > _catIndex;
+
+    DataSchema(const DataSchema& inDataSchema);
+    DataSchema& operator=(const DataSchema& inDataSchema);
+
+    const tCatInfo& GetCatInfo(const unsigned int catId) const;
+    void CheckItemId(const tCatInfo& catInfo, const unsigned int itemId) const;
+
+    static void GetRanges(std::vector<tRange>& ranges,
+      const std::vector<std::string>& mins,
+      const std::vector<std::string>& maxs);
+    static bool GetBound(double& bound, const std::string& value);
+};
+
+
+#endif
@@ -27,6 +27,15 @@ class GenCont
     static bool IsInVectorCi(const std::string& element,
       const std::vector<std::string>& contVector);
 
+    // Ordered index of a column: contVector[sortedIndices[i]] are in
+    // ascending order. Equal elements keep their relative order. Each
+    // element is converted to a collation key only once.
+    static void SortIndices(std::vector<unsigned int>& sortedIndices,
+      const std::vector<std::string>& contVector,
+      const Char::eCompareType compareType = Char::eCASE_SENSITIVE);
+    static void Sort(std::vector<std::string>& contVector,
+      const Char::eCompareType compareType = Char::eCASE_SENSITIVE);
+
   private:
     GenCont();
 
@@ -34,5 +43,51 @@ class GenCont
 };
 
 
+/**
+ ** \class LookupSet
+ **
+ ** \brief Hashed set of strings for repeated membership tests.
+ **
+ ** The set is built once from a vector of strings and then answers lookups
+ ** in constant time, instead of scanning the vector. Supported compare types
+ ** are case-sensitive, case-insensitive and white space insensitive. Find()
+ ** returns the canonical spelling of a value, which is the spelling of the
+ ** first equal string in the vector.
+ */
+class LookupSet
+{
+  public:
+    LookupSet(const Char::eCompareType compareType = Char::eCASE_SENSITIVE);
+    LookupSet(const std::vector<std::string>& values,
+      const Char::eCompareType compareType = Char::eCASE_SENSITIVE);
+
+    void Assign(const std::vector<std::string>& values);
+    void Clear();
+
+    unsigned int GetSize() const;
+    bool IsEmpty() const;
+
+    /// When not found, returns NULL
+    const std::string* Find(const std::string& value) const;
+
+    bool IsIn(const std::string& value) const;
+
+  private:
+    Char::eCompareType _compareType;
+
+    // Distinct values and their hashes
+    std::vector<std::string> _values;
+    std::vector<unsigned int> _hashes;
+
+    // Open addressing table of value indices plus one. Zero is a free slot.
+    std::vector<unsigned int> _slots;
+
+    unsigned int Hash(const std::string& value) const;
+    bool IsEqual(const std::string& value1, const std::string& value2) const;
+    unsigned int FindPos(const std::string& value,
+      const unsigned int hash) const;
+};
+
+
 #endif // GENCONT_H not defined
 
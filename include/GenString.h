@@ -9,8 +9,11 @@
 
 
 #include <string>
+#include <vector>
 #include <functional>
 
+#include "rcsb_types.h"
+
 
 /**
  ** \class Char
@@ -31,12 +34,12 @@ class Char
         eAS_INTEGER
     };
 
-    static char ToLower(const char c);
-    static char ToUpper(const char c);
+    static inline char ToLower(const char c);
+    static inline char ToUpper(const char c);
 
-    static bool IsCiLess(const char c1, const char c2);
+    static inline bool IsCiLess(const char c1, const char c2);
 
-    static bool IsWhiteSpace(const char c);
+    static inline bool IsWhiteSpace(const char c);
     static bool IsDigit(const char c);
     static bool IsCarriageReturn(const char c);
     static bool IsPrintable(const char c);
@@ -164,21 +167,73 @@ class StringEqualTo : public std::binary_function<std::string, std::string,
 class String
 {
   public:
+    enum eConvStatus
+    {
+        eCONV_OK = 0,
+        eCONV_EMPTY,       // Empty or white space only
+        eCONV_INVALID,     // Not a number
+        eCONV_OUT_OF_RANGE // Number does not fit in the type
+    };
+
     static void LowerCase(const std::string& inString, std::string& outString);
     static void LowerCase(std::string& inOutString);
+    static void LowerCase(std::vector<std::string>& inOutStrings);
     static void UpperCase(const std::string& inString, std::string& outString);
     static void UpperCase(std::string& inOutString);
+    static void UpperCase(std::vector<std::string>& inOutStrings);
 
     static void RemoveWhiteSpace(const std::string& inString,
       std::string& outString);
+    static void RemoveWhiteSpace(std::vector<std::string>& inOutStrings);
 
     static std::string IntToString(int inInteger);
     static std::string DoubleToString(double inDouble);
     static int StringToInt(const std::string& inString);
     static double StringToDouble(const std::string& inString);
+
+    // Non-throwing conversions. They accept the same input as StringToInt()
+    // and StringToDouble() (leading white space is skipped, anything after
+    // the number is an error), do not allocate and leave value unchanged
+    // on failure.
+    static eConvStatus ParseInt(int& value, const char* beg,
+      const char* end);
+    static eConvStatus ParseInt(int& value, const std::string& inString);
+    static eConvStatus ParseInt(SInt64& value, const char* beg,
+      const char* end);
+    static eConvStatus ParseInt(SInt64& value, const std::string& inString);
+    static eConvStatus ParseDouble(double& value, const char* beg,
+      const char* end);
+    static eConvStatus ParseDouble(double& value,
+      const std::string& inString);
+
+    // Column conversions. Invalid values are set to 0 and marked as false
+    // in the valid vector.
+    static void ParseInts(std::vector<int>& values, std::vector<bool>& valid,
+      const std::vector<std::string>& inStrings);
+    static void ParseDoubles(std::vector<double>& values,
+      std::vector<bool>& valid, const std::vector<std::string>& inStrings);
     static bool IsScientific(const std::string& number);
     static void ToFixedFormat(std::string& fixedFormat,
       const std::string& number);
+
+    // Formatters that append to outString and use no temporary strings.
+    // AppendDouble() writes the shortest digits that read back as the
+    // same double (Ryu algorithm), in "%g" notation. AppendFixed() writes
+    // decPlaces decimals, as used for CIF coordinates, and never writes a
+    // negative zero.
+    static void AppendInt(std::string& outString, int inInteger);
+    static void AppendDouble(std::string& outString, double inDouble);
+    static void AppendFixed(std::string& outString, double inDouble,
+      const unsigned int decPlaces);
+    static void AppendFixedFormat(std::string& outString, const char* beg,
+      const char* end);
+
+    static void IntsToStrings(std::vector<std::string>& outStrings,
+      const std::vector<int>& inIntegers);
+    static void DoublesToStrings(std::vector<std::string>& outStrings,
+      const std::vector<double>& inDoubles);
+    static void DoublesToFixedStrings(std::vector<std::string>& outStrings,
+      const std::vector<double>& inDoubles, const unsigned int decPlaces);
     static bool StringToBoolean(const std::string& inString);
 
     static bool IsNumber(const std::string& inString);
@@ -189,25 +244,253 @@ class String
       const std::string& secondString,
       const Char::eCompareType compareType);
 
+    // Collation keys. A key is computed once per value, and plain
+    // comparison of keys (operator< on strings or integers) gives the same
+    // order as StringLessT of the compare type, so that sorting does not
+    // parse or fold case on every comparison. Invalid integers throw as in
+    // StringToInt().
+    static void MakeCollationKey(std::string& key,
+      const std::string& inString, const Char::eCompareType compareType);
+    static void MakeCollationKeys(std::vector<std::string>& keys,
+      const std::vector<std::string>& inStrings,
+      const Char::eCompareType compareType);
+    static void MakeIntegerKeys(std::vector<int>& keys,
+      const std::vector<std::string>& inStrings);
+
     static void StripLeadingWs(std::string& resString);
     static void StripTrailingWs(std::string& resString);
     static void StripAndCompressWs(std::string& resString);
+    static void StripAndCompressWs(std::vector<std::string>& resStrings);
     static void rcsb_clean_string(std::string& theString);
+    static void rcsb_clean_string(std::vector<std::string>& theStrings);
 
     static void UnEscape(std::string& outStr, const std::string& inStr);
 
     static void Replace(std::string& resString, const std::string& fromStr,
       const std::string& toStr);
+};
 
-  private:
-    static std::string::const_iterator GetExpValue(int& expValue,
-      const std::string::const_iterator& beg,
-      const std::string::const_iterator& end);
-    static void GetMantissa(std::string& mantissa, int& addExpValue,
-      const std::string::const_iterator& beg,
-      const std::string::const_iterator& end);
-    static void ScientificNumberToFixed(std::string& fixed,
-      const bool isPositive, const std::string& mantissa, const int exponent);
+
+/**
+ ** \class CharLessT
+ **
+ ** \brief Character comparison with the compare type fixed at compile time.
+ **
+ ** Same ordering as CharLess, but without the per-call selection of the
+ ** compare type, so that the comparison can be inlined. Specialized for
+ ** case-sensitive, case-insensitive and white space insensitive compare
+ ** types.
+ */
+template <Char::eCompareType compareType>
+class CharLessT;
+
+template <>
+class CharLessT<Char::eCASE_SENSITIVE> :
+  public std::binary_function<char, char, bool>
+{
+  public:
+    inline bool operator()(const char c1, const char c2) const;
+};
+
+template <>
+class CharLessT<Char::eCASE_INSENSITIVE> :
+  public std::binary_function<char, char, bool>
+{
+  public:
+    inline bool operator()(const char c1, const char c2) const;
+};
+
+template <>
+class CharLessT<Char::eWS_INSENSITIVE> :
+  public std::binary_function<char, char, bool>
+{
+  public:
+    inline bool operator()(const char c1, const char c2) const;
+};
+
+
+/**
+ ** \class CharEqualToT
+ **
+ ** \brief Character equal_to functor with the compare type fixed at compile
+ ** time.
+ **
+ ** Same result as CharEqualTo, but with a single comparison per call.
+ ** Specialized for case-sensitive, case-insensitive and white space
+ ** insensitive compare types.
+ */
+template <Char::eCompareType compareType>
+class CharEqualToT;
+
+template <>
+class CharEqualToT<Char::eCASE_SENSITIVE> :
+  public std::binary_function<char, char, bool>
+{
+  public:
+    inline bool operator()(const char c1, const char c2) const;
+};
+
+template <>
+class CharEqualToT<Char::eCASE_INSENSITIVE> :
+  public std::binary_function<char, char, bool>
+{
+  public:
+    inline bool operator()(const char c1, const char c2) const;
+};
+
+template <>
+class CharEqualToT<Char::eWS_INSENSITIVE> :
+  public std::binary_function<char, char, bool>
+{
+  public:
+    inline bool operator()(const char c1, const char c2) const;
+};
+
+
+/**
+ ** \class StringLessT
+ **
+ ** \brief String comparison with the compare type fixed at compile time.
+ **
+ ** Same ordering as StringLess, but without the per-call selection of the
+ ** compare type, so that std::map and sorting can inline it. Specialized
+ ** for case-sensitive, case-insensitive, white space insensitive (where all
+ ** white space characters are equivalent) and as-integer compare types.
+ */
+template <Char::eCompareType compareType>
+class StringLessT;
+
+template <>
+class StringLessT<Char::eCASE_SENSITIVE> :
+  public std::binary_function<std::string, std::string, bool>
+{
+  public:
+    inline bool operator()(const std::string& s1,
+      const std::string& s2) const;
+};
+
+template <>
+class StringLessT<Char::eCASE_INSENSITIVE> :
+  public std::binary_function<std::string, std::string, bool>
+{
+  public:
+    inline bool operator()(const std::string& s1,
+      const std::string& s2) const;
+};
+
+template <>
+class StringLessT<Char::eWS_INSENSITIVE> :
+  public std::binary_function<std::string, std::string, bool>
+{
+  public:
+    inline bool operator()(const std::string& s1,
+      const std::string& s2) const;
+};
+
+template <>
+class StringLessT<Char::eAS_INTEGER> :
+  public std::binary_function<std::string, std::string, bool>
+{
+  public:
+    inline bool operator()(const std::string& s1,
+      const std::string& s2) const;
+};
+
+
+/**
+ ** \class StringEqualToT
+ **
+ ** \brief String equal_to functor with the compare type fixed at compile
+ ** time.
+ **
+ ** Same result as StringEqualTo, but done in a single pass over the
+ ** strings instead of two less-than comparisons. Specialized for the same
+ ** compare types as StringLessT.
+ */
+template <Char::eCompareType compareType>
+class StringEqualToT;
+
+template <>
+class StringEqualToT<Char::eCASE_SENSITIVE> :
+  public std::binary_function<std::string, std::string, bool>
+{
+  public:
+    inline bool operator()(const std::string& s1,
+      const std::string& s2) const;
+};
+
+template <>
+class StringEqualToT<Char::eCASE_INSENSITIVE> :
+  public std::binary_function<std::string, std::string, bool>
+{
+  public:
+    inline bool operator()(const std::string& s1,
+      const std::string& s2) const;
+};
+
+template <>
+class StringEqualToT<Char::eWS_INSENSITIVE> :
+  public std::binary_function<std::string, std::string, bool>
+{
+  public:
+    inline bool operator()(const std::string& s1,
+      const std::string& s2) const;
+};
+
+template <>
+class StringEqualToT<Char::eAS_INTEGER> :
+  public std::binary_function<std::string, std::string, bool>
+{
+  public:
+    inline bool operator()(const std::string& s1,
+      const std::string& s2) const;
+};
+
+
+/**
+ ** \class StringHashT
+ **
+ ** \brief String hash functor consistent with StringEqualToT.
+ **
+ ** Strings that are equal according to StringEqualToT of the same compare
+ ** type have the same hash. Text is hashed with 32-bit FNV-1a, after case
+ ** folding (case-insensitive) or after mapping all white space characters
+ ** to a blank (white space insensitive). As-integer strings are hashed by
+ ** their integer value.
+ */
+template <Char::eCompareType compareType>
+class StringHashT;
+
+template <>
+class StringHashT<Char::eCASE_SENSITIVE> :
+  public std::unary_function<std::string, unsigned int>
+{
+  public:
+    inline unsigned int operator()(const std::string& s) const;
+};
+
+template <>
+class StringHashT<Char::eCASE_INSENSITIVE> :
+  public std::unary_function<std::string, unsigned int>
+{
+  public:
+    inline unsigned int operator()(const std::string& s) const;
+};
+
+template <>
+class StringHashT<Char::eWS_INSENSITIVE> :
+  public std::unary_function<std::string, unsigned int>
+{
+  public:
+    inline unsigned int operator()(const std::string& s) const;
+};
+
+template <>
+class StringHashT<Char::eAS_INTEGER> :
+  public std::unary_function<std::string, unsigned int>
+{
+  public:
+    inline unsigned int operator()(const std::string& s) const;
 };
 
 
@@ -221,4 +504,228 @@ inline Char::eCompareType StringEqualTo::GetCompareType()
     return (_compareType);
 }
 
+inline char Char::ToLower(const char c)
+{
+    if (!((c >= 'A') && (c <= 'Z')))
+    {
+        // If not an uppercase letter, just return that character.
+        return c;
+    }
+
+    return (c + ('a' - 'A'));
+}
+
+inline char Char::ToUpper(const char c)
+{
+    if (!((c >= 'a') && (c <= 'z')))
+    {
+        // If not a lowercase letter, just return that character.
+        return c;
+    }
+
+    return (c - ('a' - 'A'));
+}
+
+inline bool Char::IsCiLess(const char c1, const char c2)
+{
+    return (Char::ToLower(c1) < Char::ToLower(c2));
+}
+
+inline bool Char::IsWhiteSpace(const char c)
+{
+    return ((c == ' ') || (c == '\n') || (c == '\t') || (c == '\f') ||
+      (c == '\v') || (c == '\r'));
+}
+
+inline bool CharLessT<Char::eCASE_SENSITIVE>::operator()(const char c1,
+  const char c2) const
+{
+    return (c1 < c2);
+}
+
+inline bool CharLessT<Char::eCASE_INSENSITIVE>::operator()(const char c1,
+  const char c2) const
+{
+    return (Char::IsCiLess(c1, c2));
+}
+
+inline bool CharLessT<Char::eWS_INSENSITIVE>::operator()(const char c1,
+  const char c2) const
+{
+    // All white space orders as a blank, consistently with the equality
+    // and the hash
+    const char f1 = Char::IsWhiteSpace(c1) ? ' ' : c1;
+    const char f2 = Char::IsWhiteSpace(c2) ? ' ' : c2;
+
+    return (f1 < f2);
+}
+
+inline bool CharEqualToT<Char::eCASE_SENSITIVE>::operator()(const char c1,
+  const char c2) const
+{
+    return (c1 == c2);
+}
+
+inline bool CharEqualToT<Char::eCASE_INSENSITIVE>::operator()(const char c1,
+  const char c2) const
+{
+    return (Char::ToLower(c1) == Char::ToLower(c2));
+}
+
+inline bool CharEqualToT<Char::eWS_INSENSITIVE>::operator()(const char c1,
+  const char c2) const
+{
+    return ((c1 == c2) || (Char::IsWhiteSpace(c1) && Char::IsWhiteSpace(c2)));
+}
+
+inline bool StringLessT<Char::eCASE_SENSITIVE>::operator()(
+  const std::string& s1, const std::string& s2) const
+{
+    return (s1 < s2);
+}
+
+inline bool StringLessT<Char::eCASE_INSENSITIVE>::operator()(
+  const std::string& s1, const std::string& s2) const
+{
+    const std::string::size_type len = (s1.size() < s2.size()) ?
+      s1.size() : s2.size();
+
+    for (std::string::size_type i = 0; i < len; ++i)
+    {
+        const char c1 = Char::ToLower(s1[i]);
+        const char c2 = Char::ToLower(s2[i]);
+
+        if (c1 != c2)
+        {
+            return (c1 < c2);
+        }
+    }
+
+    return (s1.size() < s2.size());
+}
+
+inline bool StringLessT<Char::eWS_INSENSITIVE>::operator()(
+  const std::string& s1, const std::string& s2) const
+{
+    const std::string::size_type len = (s1.size() < s2.size()) ?
+      s1.size() : s2.size();
+
+    for (std::string::size_type i = 0; i < len; ++i)
+    {
+        const char c1 = Char::IsWhiteSpace(s1[i]) ? ' ' : s1[i];
+        const char c2 = Char::IsWhiteSpace(s2[i]) ? ' ' : s2[i];
+
+        if (c1 != c2)
+        {
+            return (c1 < c2);
+        }
+    }
+
+    return (s1.size() < s2.size());
+}
+
+inline bool StringLessT<Char::eAS_INTEGER>::operator()(
+  const std::string& s1, const std::string& s2) const
+{
+    return (String::StringToInt(s1) < String::StringToInt(s2));
+}
+
+inline bool StringEqualToT<Char::eCASE_SENSITIVE>::operator()(
+  const std::string& s1, const std::string& s2) const
+{
+    return (s1 == s2);
+}
+
+inline bool StringEqualToT<Char::eCASE_INSENSITIVE>::operator()(
+  const std::string& s1, const std::string& s2) const
+{
+    if (s1.size() != s2.size())
+    {
+        return (false);
+    }
+
+    for (std::string::size_type i = 0; i < s1.size(); ++i)
+    {
+        if (Char::ToLower(s1[i]) != Char::ToLower(s2[i]))
+        {
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+inline bool StringEqualToT<Char::eWS_INSENSITIVE>::operator()(
+  const std::string& s1, const std::string& s2) const
+{
+    if (s1.size() != s2.size())
+    {
+        return (false);
+    }
+
+    for (std::string::size_type i = 0; i < s1.size(); ++i)
+    {
+        if (!CharEqualToT<Char::eWS_INSENSITIVE>()(s1[i], s2[i]))
+        {
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+inline bool StringEqualToT<Char::eAS_INTEGER>::operator()(
+  const std::string& s1, const std::string& s2) const
+{
+    return (String::StringToInt(s1) == String::StringToInt(s2));
+}
+
+inline unsigned int StringHashT<Char::eCASE_SENSITIVE>::operator()(
+  const std::string& s) const
+{
+    unsigned int hash = 2166136261U;
+
+    for (std::string::size_type i = 0; i < s.size(); ++i)
+    {
+        hash = (hash ^ static_cast<unsigned char>(s[i])) * 16777619U;
+    }
+
+    return (hash);
+}
+
+inline unsigned int StringHashT<Char::eCASE_INSENSITIVE>::operator()(
+  const std::string& s) const
+{
+    unsigned int hash = 2166136261U;
+
+    for (std::string::size_type i = 0; i < s.size(); ++i)
+    {
+        hash = (hash ^ static_cast<unsigned char>(Char::ToLower(s[i]))) *
+          16777619U;
+    }
+
+    return (hash);
+}
+
+inline unsigned int StringHashT<Char::eWS_INSENSITIVE>::operator()(
+  const std::string& s) const
+{
+    unsigned int hash = 2166136261U;
+
+    for (std::string::size_type i = 0; i < s.size(); ++i)
+    {
+        const char c = Char::IsWhiteSpace(s[i]) ? ' ' : s[i];
+
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619U;
+    }
+
+    return (hash);
+}
+
+inline unsigned int StringHashT<Char::eAS_INTEGER>::operator()(
+  const std::string& s) const
+{
+    return (static_cast<unsigned int>(String::StringToInt(s)));
+}
+
 #endif
@@ -0,0 +1,124 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file MappedDataInfo.h
+**
+** Data info class, backed by a memory mapped dictionary snapshot.
+*/
+
+
+#ifndef MAPPEDDATAINFO_H
+#define MAPPEDDATAINFO_H
+
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+
+#include "rcsb_types.h"
+#include "DataInfo.h"
+
+
+/**
+ ** \class MappedDataInfo
+ **
+ ** \brief Data info that answers queries from a binary dictionary snapshot.
+ **
+ ** Write() stores the categories, items, category keys and selected
+ ** category and item attributes of any DataInfo into a versioned binary
+ ** file, which replaces any existing file atomically. The constructor maps
+ ** that file into memory, so that loading the dictionary is a page-in,
+ ** instead of a parse. Strings are stored once and referenced by ID, and
+ ** lists of strings are materialized into vectors on first use only. Names
+ ** are looked up case-sensitively, with binary search in the mapped file.
+ ** Attributes that were not selected at write time are returned as empty
+ ** vectors.
+ **
+ ** The file is in the byte order of the machine that wrote it. Reading it
+ ** on a machine with the other byte order fails.
+ */
+class MappedDataInfo : public DataInfo
+{
+  public:
+    typedef std::pair<std::string, std::string> tAttrib;
+
+    MappedDataInfo(const std::string& fileName);
+    virtual ~MappedDataInfo();
+
+    static void Write(const std::string& fileName, DataInfo& dataInfo,
+      const std::vector<tAttrib>& catAttribs,
+      const std::vector<tAttrib>& itemAttribs);
+
+    // Attributes used by DataInfo and DataSchema, and parent/child links
+    static void GetDefaultCatAttribs(std::vector<tAttrib>& catAttribs);
+    static void GetDefaultItemAttribs(std::vector<tAttrib>& itemAttribs);
+
+    virtual void GetVersion(std::string& version);
+
+    virtual const std::vector<std::string>& GetCatNames();
+
+    virtual const std::vector<std::string>& GetItemsNames();
+
+    virtual bool IsCatDefined(const std::string& catName) const;
+
+    virtual bool IsItemDefined(const std::string& itemName);
+
+    virtual const std::vector<std::string>&
+      GetCatKeys(const std::string& catName);
+
+    virtual const std::vector<std::string>&
+      GetCatAttribute(const std::string& catName,
+      const std::string& refCatName, const std::string& refAttribName);
+
+    virtual const std::vector<std::string>&
+      GetItemAttribute(const std::string& itemName,
+      const std::string& refCatName, const std::string& refAttribName);
+
+  private:
+    static const UInt32 _version = 1;
+
+    std::string _fileName;
+
+    const char* _data;
+    UInt32 _size;
+
+    const UInt32* _header;
+    const UInt32* _stringOffsets;
+    const char* _stringChars;
+    const UInt32* _cats;
+    const UInt32* _items;
+    const UInt32* _attribs;
+    const UInt32* _lists;
+
+    // Materialized lists, by their position in the lists section
+    std::map<UInt32, std::vector<std::string> > _listCache;
+
+    MappedDataInfo(const MappedDataInfo& inMappedDataInfo);
+    MappedDataInfo& operator=(const MappedDataInfo& inMappedDataInfo);
+
+    void Map();
+    void Unmap();
+
+    const UInt32* GetSection(const UInt32 pos, const UInt32 numRecords,
+      const UInt32 recordWords = 1) const;
+
+    void GetStringRange(UInt32& beg, UInt32& len,
+      const UInt32 stringId) const;
+    int CompareString(const UInt32 stringId, const std::string& str) const;
+    void GetString(std::string& str, const UInt32 stringId) const;
+
+    UInt32 FindRecord(const UInt32* records, const UInt32 numRecords,
+      const UInt32 recordWords, const std::string& name) const;
+    UInt32 FindAttrib(const UInt32 firstAttrib, const UInt32 numAttribs,
+      const std::string& refCatName, const std::string& refAttribName) const;
+
+    const std::vector<std::string>& GetList(const UInt32 listPos);
+};
+
+
+#endif
@@ -0,0 +1,45 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+#ifndef RCSBCHECKSUM_H
+#define RCSBCHECKSUM_H
+
+
+#include "rcsb_types.h"
+
+
+/**
+** \class RcsbChecksum
+**
+** \brief Static class that computes checksums of data.
+**
+** CRC32C (Castagnoli) is computed with the CRC32 instructions of SSE 4.2
+** or ARMv8 when the CPU has them, and with tables otherwise. All
+** implementations give the same result. A checksum can be computed in
+** parts, by passing the checksum of the previous parts as crc.
+**
+** Hash64 is a fast, non-cryptographic 64-bit hash (MurmurHash64A) for
+** finding candidate duplicates. Data is read as little-endian words, so
+** the hash is the same on all platforms.
+*/
+class RcsbChecksum
+{
+  public:
+    static UInt32 Crc32c(const void* data, const unsigned int length,
+      const UInt32 crc = 0);
+
+    static UInt64 Hash64(const void* data, const unsigned int length,
+      const UInt64 seed = 0);
+
+  private:
+    RcsbChecksum();
+
+    ~RcsbChecksum();
+};
+
+
+#endif // RCSBCHECKSUM_H not defined
+
@@ -8,13 +8,28 @@
 #define RCSBFILE_H
 
 
+#include <sys/types.h>
+
 #include <string>
+#include <vector>
 #include <fstream>
 
+#include "rcsb_types.h"
+
 
 class RcsbFile
 {
   public:
+    // Access pattern hints for Advise()
+    enum eAdvice
+    {
+        eADVICE_NORMAL = 0,
+        eADVICE_SEQUENTIAL, // Data will be accessed once, in order
+        eADVICE_RANDOM,     // Data will be accessed in random order
+        eADVICE_WILL_NEED,  // Data will be accessed soon
+        eADVICE_DONT_NEED   // Cached data will not be accessed again
+    };
+
     static const std::string DIR_SEPARATOR;
 
     static bool IsEmpty(std::ofstream& fileStream);
@@ -22,11 +37,48 @@ class RcsbFile
 
     static void RelativeFileName(std::string& relName,
       const std::string& absName);
+    static void DirName(std::string& dirName, const std::string& fileName);
+
+    // Crash-safe publication. Data is written to a temporary file, in the
+    // directory of the final file, which is then renamed over the final
+    // file. Readers see either the old or the new file, never a partially
+    // written one. CreateTempFile() creates the file with the permission
+    // bits of mode, less the umask, which the final file keeps.
+    static void MakeTempFileName(std::string& tempName,
+      const std::string& fileName);
+    static int CreateTempFile(std::string& tempName,
+      const std::string& fileName, const mode_t mode = 0666);
+    static void Publish(const std::string& tempName,
+      const std::string& fileName, const bool sync = true);
+    static void PublishFiles(const std::vector<std::string>& tempNames,
+      const std::vector<std::string>& fileNames);
+
+    // Reserves disk space for size bytes, without changing the file size
+    // where the system allows it. Returns false if the space could not be
+    // reserved, which is not an error.
+    static bool Preallocate(const int fd, const UInt64 size);
+
+    // Returns false if the hint is not supported, which is not an error.
+    // Length of 0 means up to the end of the file.
+    static bool Advise(const int fd, const eAdvice advice,
+      const UInt64 offset = 0, const UInt64 length = 0);
+
+    // Flushes file data, and the metadata needed to read it, to disk.
+    static void Sync(const int fd);
+
+    // Flushes many files, and their directories, to disk. Write-back of
+    // all files is started before waiting on any of them.
+    static void SyncFiles(const std::vector<std::string>& fileNames);
+    static void SyncDir(const std::string& dirName);
 
   private:
     RcsbFile();
 
     ~RcsbFile();
+
+    static void SyncFds(const std::vector<int>& fds,
+      const std::vector<std::string>& fileNames);
+    static void SyncDirs(const std::vector<std::string>& fileNames);
 };
 
 
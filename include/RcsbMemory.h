@@ -0,0 +1,124 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file RcsbMemory.h
+**
+** Memory resources, for allocating memory that is released all at once.
+*/
+
+
+#ifndef RCSBMEMORY_H
+#define RCSBMEMORY_H
+
+
+#include <stddef.h>
+
+
+/**
+** \class RcsbMemoryResource
+**
+** \brief Abstract source of memory, which containers allocate from through
+** resource_allocator.
+**
+** Alignment is a power of 2. The default alignment is enough for any
+** fundamental type. Memory must be deallocated with the same size and
+** alignment it was allocated with. GetDefault() returns a resource that
+** uses the global operator new.
+*/
+class RcsbMemoryResource
+{
+  public:
+    static const size_t DEFAULT_ALIGNMENT = 2 * sizeof(void*);
+
+    virtual ~RcsbMemoryResource();
+
+    /// Throws std::bad_alloc if memory cannot be allocated
+    void* Allocate(const size_t bytes,
+      const size_t alignment = DEFAULT_ALIGNMENT);
+    void Deallocate(void* p, const size_t bytes,
+      const size_t alignment = DEFAULT_ALIGNMENT);
+
+    /// True if memory from one resource can be deallocated by the other
+    bool IsEqual(const RcsbMemoryResource& other) const;
+
+    static RcsbMemoryResource* GetDefault();
+
+  protected:
+    virtual void* DoAllocate(const size_t bytes, const size_t alignment) = 0;
+    virtual void DoDeallocate(void* p, const size_t bytes,
+      const size_t alignment) = 0;
+    virtual bool DoIsEqual(const RcsbMemoryResource& other) const;
+};
+
+
+/**
+** \class RcsbArena
+**
+** \brief Memory resource that allocates from large chunks and releases
+** memory only when the arena is released or destroyed.
+**
+** Allocation is a pointer increment and deallocation does nothing, so
+** memory that containers draw from the arena, e.g., for all data of one
+** request, is freed by one Release() instead of one free per allocation.
+** Only that memory is: containers still destroy their elements, and what
+** they or the elements allocate elsewhere, e.g., the characters of
+** std::string names and frozen indices, is freed one by one.
+**
+** Chunks are allocated from the upstream resource and grow geometrically,
+** up to MAX_CHUNK_SIZE. An arena is not thread-safe. Use one arena per
+** thread, so that threads do not contend on the global heap.
+*/
+class RcsbArena : public RcsbMemoryResource
+{
+  public:
+    static const size_t MAX_CHUNK_SIZE = 16 * 1024 * 1024;
+
+    RcsbArena(const size_t initialChunkSize = 64 * 1024,
+      RcsbMemoryResource* upstream = NULL);
+    virtual ~RcsbArena();
+
+    /// Frees all memory allocated from the arena
+    void Release();
+
+    /// Number of bytes handed out since the last release
+    size_t GetNumBytes() const;
+
+    RcsbMemoryResource* GetUpstream() const;
+
+  protected:
+    virtual void* DoAllocate(const size_t bytes, const size_t alignment);
+    virtual void DoDeallocate(void* p, const size_t bytes,
+      const size_t alignment);
+
+  private:
+    struct tChunk
+    {
+        tChunk* next;
+        size_t size;
+    };
+
+    RcsbMemoryResource* _upstream;
+
+    size_t _initialChunkSize;
+    size_t _nextChunkSize;
+
+    tChunk* _chunks;
+
+    char* _current;
+    char* _end;
+
+    size_t _numBytes;
+
+    RcsbArena(const RcsbArena& inArena);
+    RcsbArena& operator=(const RcsbArena& inArena);
+
+    void AddChunk(const size_t minSize);
+};
+
+
+#endif // RCSBMEMORY_H not defined
+
@@ -11,6 +11,34 @@
 #include "rcsb_types.h"
 
 
+// AVX2 code is compiled when the compiler targets AVX2. With GCC 4.9+ and
+// clang on x86, it is also compiled into functions marked with
+// RCSB_TARGET_AVX2, which must only be called when
+// RcsbPlatform::HasCpuFeatures(RcsbPlatform::eCPU_AVX2) is true.
+#if defined(__AVX2__)
+#define RCSB_AVX2_KERNELS
+#define RCSB_TARGET_AVX2
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || \
+  (defined(__GNUC__) && ((__GNUC__ > 4) || \
+  ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))))
+#define RCSB_AVX2_KERNELS
+#define RCSB_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// SSE 4.2 code, likewise, is compiled into functions marked with
+// RCSB_TARGET_SSE42, which must only be called when
+// RcsbPlatform::HasCpuFeatures(RcsbPlatform::eCPU_SSE42) is true.
+#if defined(__SSE4_2__)
+#define RCSB_SSE42_KERNELS
+#define RCSB_TARGET_SSE42
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || \
+  (defined(__GNUC__) && ((__GNUC__ > 4) || \
+  ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))))
+#define RCSB_SSE42_KERNELS
+#define RCSB_TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+
+
 class RcsbPlatform
 {
   public:
@@ -19,9 +47,71 @@ class RcsbPlatform
 
     static bool IsLittleEndian();
 
+    enum eCpuFeature
+    {
+        eCPU_SSE2 = 0x0001,
+        eCPU_SSE42 = 0x0002,
+        eCPU_AVX2 = 0x0004,
+        eCPU_AVX512 = 0x0008, // AVX-512 F and BW
+        eCPU_BMI2 = 0x0010,
+        eCPU_CRC32 = 0x0020   // CRC32C instructions
+    };
+
+    // Features of the CPU, which the operating system also supports.
+    // They are detected on the first call.
+    static UInt32 GetCpuFeatures();
+    static bool HasCpuFeatures(const UInt32 features);
+
+    // Hides features from GetCpuFeatures(), e.g., to test fallback code.
+    // Code that has already selected an implementation is not affected.
+    static void DisableCpuFeatures(const UInt32 features);
+
+    // One implementation of a dispatched function, and the features that
+    // it requires. Function pointers are cast to and from tFunc.
+    typedef void (*tFunc)();
+
+    struct tCpuImpl
+    {
+        UInt32 features;
+        tFunc func;
+    };
+
+    // Returns the first implementation whose features the CPU has. The
+    // last one should require no features. Callers keep the result, e.g.,
+    // in a function-local static, so the selection is done once.
+    static tFunc SelectImpl(const tCpuImpl* impls,
+      const unsigned int numImpls);
+
+    // Atomically increments/decrements the value and returns the new value.
+    static UInt32 AtomicIncrement(volatile UInt32& value);
+    static UInt32 AtomicDecrement(volatile UInt32& value);
+
+    static unsigned int GetNumProcessors();
+
+    // Processes the range [0, num) in chunks, by calling
+    // func(arg, chunk, beg, end) for each chunk on its own thread, and
+    // waits for all of them. GetNumChunks() gives the number of chunks to
+    // use, which is at most numThreads (number of processors, if 0) and
+    // with at least minChunkSize elements per chunk. The first chunk runs
+    // on the calling thread. If func throws, the exception of the first
+    // failed chunk is thrown again after all chunks complete, as a copy of
+    // its most derived library or standard exception type.
+    typedef void (*tChunkFunc)(void* arg, const unsigned int chunk,
+      const unsigned int beg, const unsigned int end);
+
+    static unsigned int GetNumChunks(const unsigned int num,
+      const unsigned int minChunkSize, unsigned int numThreads = 0);
+    static void ParallelFor(tChunkFunc func, void* arg,
+      const unsigned int num, const unsigned int numChunks);
+
   private:
     static const UInt16 _ENDIANNESS_TEST_INT;
 
+    static volatile UInt32 _cpuFeatures;
+    static volatile UInt32 _disabledCpuFeatures;
+
+    static UInt32 DetectCpuFeatures();
+
 };
 
 
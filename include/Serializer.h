@@ -10,9 +10,11 @@
 
 #include <string>
 #include <vector>
+#include <map>
 #include <fstream>
 
 #include "rcsb_types.h"
+#include "RcsbMemory.h"
 #include "BlockIO.h"
 
 
@@ -43,19 +45,95 @@ enum eFileMode
 class Serializer
 {
   public:
-    // Constructors and destructor
+    // Options for opening files
+    enum eFlags
+    {
+        // Write to a temporary file that is renamed to the file name on
+        // close. Only in CREATE_MODE.
+        eWRITE_ATOMIC = 0x01,
+
+        // Flush the file to disk on close
+        eWRITE_SYNC = 0x02,
+
+        // Drop the file data from the page cache on close. Most effective
+        // together with eWRITE_SYNC.
+        eWRITE_DONT_CACHE = 0x04,
+
+        // Store a CRC32C checksum of every block. Files that have them
+        // keep them when updated.
+        eWRITE_CHECKSUMS = 0x08,
+
+        // Check the checksum of every block that is read, if the file has
+        // them. A mismatch throws FileException.
+        eREAD_VERIFY = 0x10,
+
+        // Store equal values once. Each written value is hashed, and if an
+        // earlier value of the same type has equal data, the new entry
+        // shares it. Shared data is never updated in place. A file with
+        // shared entries has format version 2. Files of a version newer
+        // than this class knows are not opened in UPDATE_MODE.
+        eWRITE_DEDUP = 0x20
+    };
+
+    // Constructors and destructor. If expectedSize is given, disk space
+    // for that many bytes is reserved up front. The destructor closes the
+    // file, if Close() has not, and ignores errors.
     Serializer(const std::string& fileName, const eFileMode fileMode,
-      const bool verbose = false);
+      const bool verbose = false, const unsigned int flags = 0,
+      const UInt64 expectedSize = 0);
     ~Serializer();
 
+    // Writes the pending data and the header, closes the file and, with
+    // eWRITE_ATOMIC, publishes it. Errors throw FileException, and an
+    // atomically written file is then not published. No other method may
+    // be called afterwards.
+    void Close();
+
     inline unsigned int GetNumDataIndices();
 
+    bool HasChecksums() const;
+
+    // Checks all blocks of the file against their checksums, reading the
+    // file sequentially. Only in READ_MODE, for files with checksums.
+    // Returns true if all blocks are intact.
+    bool Verify();
+    bool Verify(std::vector<UInt32>& badBlocks);
+
+    // Results of the TryRead methods
+    enum eReadStatus
+    {
+        eREAD_OK = 0,
+        eREAD_WRONG_MODE,     // File is not open for reading
+        eREAD_INVALID_INDEX,  // Index is out of range
+        eREAD_DELETED,        // Index has been deleted
+        eREAD_WRONG_TYPE,     // Entry is of another type
+        eREAD_SHORT,          // File is shorter than the entry
+        eREAD_INVALID_LENGTH  // Entry length does not match its contents
+    };
+
+    // Non-throwing read methods. On failure, the output is cleared. I/O
+    // errors still throw.
+    eReadStatus TryReadUInt32(UInt32& theWord, const UInt32 index);
+    eReadStatus TryReadUInt32s(std::vector<UInt32>& UInt32s,
+      const UInt32 index);
+    eReadStatus TryReadString(std::string& retString, const UInt32 index);
+    eReadStatus TryReadStrings(std::vector<std::string>& theStrings,
+      const UInt32 index);
+
     // Read methods
     UInt32 ReadUInt32(const UInt32 index);
     void ReadUInt32s(std::vector<UInt32>& UInt32s, const UInt32 index);
     void ReadString(std::string& retString, const UInt32 index);
     void ReadStrings(std::vector<std::string>& theStrings, const UInt32 index);
 
+    // Read the strings into memory of the resource, as NUL terminated
+    // strings that are never deallocated individually. Meant for an
+    // RcsbArena, which frees all strings at once when it is released.
+    eReadStatus TryReadStrings(std::vector<const char*>& theStrings,
+      RcsbMemoryResource& resource, const UInt32 index);
+    void ReadStrings(std::vector<const char*>& theStrings,
+      RcsbMemoryResource& resource, const UInt32 index);
+
     // Write methods 
     UInt32 WriteUInt32(const UInt32 theWord);
     UInt32 WriteUInt32s(const std::vector<UInt32>& theWords);
@@ -85,7 +163,8 @@ class Serializer
         // Number of indices
         UInt32 numIndices;
 
-        // Reserved information
+        // Reserved information: flags, block number of the checksums and
+        // number of blocks that have checksums
         UInt32 reserved[3];
 
         // File version
@@ -102,12 +181,23 @@ class Serializer
         UInt32 length;      // The length of the data 
         UInt32 dataType;    // Type of data
         UInt32 vLength;     // Virtual length (length adjusted for word size)
-        UInt32 reserved[3];
+        UInt32 reserved[3]; // Entry flags and the hash of the data
     } EntryIndex;
 
     static bool _littleEndian;
 
+    // File format versions. Version 2 files may have shared entries.
     static const UInt32 _version = 1;
+    static const UInt32 _sharedVersion = 2;
+
+    // Header flags, in reserved[0]
+    static const UInt32 _checksumsFlag = 0x01;
+
+    // Entry flags, in reserved[0]. The 64-bit hash of the data of a hashed
+    // entry is in reserved[1] (low word) and reserved[2] (high word).
+    static const UInt32 _sharedFlag = 0x01;
+    static const UInt32 _hashedFlag = 0x02;
+
     static const UInt32 _indicesPerBlock = BLKSIZE / sizeof(EntryIndex);
 
     // An array of index entries (i.e., these are indices)
@@ -125,14 +215,35 @@ class Serializer
     UInt32 _currentBlock;  // The current block number of the current buffer
     UInt32 _currentOffset; // The offset into the current buffer
 
+    // End of the data that ends last. With shared data, the last entry
+    // does not always have it.
+    UInt32 _dataEndBlock;
+    UInt32 _dataEndOffset;
+
     char* _buffer;
 
     eFileMode _mode;
 
+    unsigned int _flags;
+    std::string _tempFileName; // Written file, in eWRITE_ATOMIC mode
+    bool _preallocated;
+
+    // Checksums of blocks, by block number, and whether they are known
+    std::vector<UInt32> _blockCrcs;
+    std::vector<bool> _blockCrcValid;
+
+    // Entry that has the data of each hash, in eWRITE_DEDUP mode
+    std::map<UInt64, UInt32> _dedupIndex;
+
     BlockIO _theBlock; // A block for doing read/write a block at a time
 
     void Init();
 
+    eReadStatus CheckReadIndex(const UInt32 index, const UInt32 dataType,
+      const UInt32 altDataType) const;
+    static void ThrowReadError(const eReadStatus status,
+      const char* typeName, const char* method);
+
     void WriteUInt32AtIndex(const UInt32 theWord, const UInt32 index);
     void WriteUInt32sAtIndex(const std::vector<UInt32>& Words,
       const UInt32 index);
@@ -142,8 +253,30 @@ class Serializer
 
     void Delete(const UInt32 index);
 
+    bool FitsInPlace(const UInt32 index, const UInt32 length) const;
+
+    // Data of values, as it is stored in the file, for eWRITE_DEDUP mode
+    void GetData(std::string& data, const UInt32 theWord);
+    void GetData(std::string& data, const std::vector<UInt32>& theWords);
+    void GetData(std::string& data, const std::string& theString);
+    void GetData(std::string& data,
+      const std::vector<std::string>& theStrings);
+
+    UInt32 WriteDedup(const std::string& data, const UInt32 dataType);
+    void WriteDataAtIndex(const std::string& data, const UInt32 dataType,
+      const UInt32 index);
+    bool IsDataEqual(const UInt32 index, const std::string& data,
+      const UInt32 dataType);
+
+    void SetDataHash(const UInt32 index, const UInt64 hash);
+    UInt64 GetDataHash(const UInt32 index) const;
+    void BuildDedupIndex();
+
+    void UpdateDataEnd(const UInt32 index);
+
     void GetLastDataBuffer(void);
     void GetDataBufferAtIndex(const UInt32 index);
+    char* GetNextDataBuffer();
 
     void _GetHeader(const char* where);
     void _PutHeader(char* where);
@@ -161,6 +294,10 @@ class Serializer
     void _ReadFileHeader();
     void _WriteFileHeader();
 
+    void SetBlockCrc(const UInt32 blockNum, const UInt32 crc);
+    void ReadChecksums();
+    void WriteChecksums(const UInt32 numBlocks);
+
     void AllocateIndices(const UInt32 index);
 
     UInt32 ReadBlock(const UInt32 blockNum);
@@ -177,7 +314,8 @@ class Serializer
     UInt32 _currentBlockIO; // The block that is currently read into buffer
 
     void OpenFileIO(const std::string& filename, const eFileMode fileMode);
-    void CloseFileIO();
+    void CloseFile(const bool discard);
+    void CloseFileIO(const bool discard = false);
 
     inline UInt32 GetCurrentBlockNumberIO() const;
     inline UInt32 GetNumBlocksIO() const;
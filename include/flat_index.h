@@ -0,0 +1,237 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file flat_index.h
+*/
+
+
+#ifndef FLAT_INDEX_H
+#define FLAT_INDEX_H
+
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+#include "GenString.h"
+
+
+/**
+** Key traits of flat_index. String keys of comparators whose order can be
+** computed directly from the characters are stored back to back in one
+** character array, compared there, and found through a hash table with
+** a hash that is consistent with the comparator. Keys of other comparators
+** are stored in an array of keys, and found with a binary search.
+*/
+template <typename KeyT, typename KeyCompareT>
+struct flat_key_traits
+{
+    static const bool contiguous = false;
+};
+
+
+// Byte order, the order of std::string::compare()
+struct flat_key_bytes_traits
+{
+    static const bool contiguous = true;
+
+    typedef StringHashT<Char::eCASE_SENSITIVE> hasher;
+
+    static inline int compare(const char* s1, const unsigned int n1,
+      const char* s2, const unsigned int n2);
+};
+
+
+template <>
+struct flat_key_traits<std::string, std::less<std::string> > :
+  public flat_key_bytes_traits
+{
+
+};
+
+
+template <>
+struct flat_key_traits<std::string, StringLessT<Char::eCASE_SENSITIVE> > :
+  public flat_key_bytes_traits
+{
+
+};
+
+
+template <>
+struct flat_key_traits<std::string, StringLessT<Char::eCASE_INSENSITIVE> >
+{
+    static const bool contiguous = true;
+
+    typedef StringHashT<Char::eCASE_INSENSITIVE> hasher;
+
+    static inline int compare(const char* s1, const unsigned int n1,
+      const char* s2, const unsigned int n2);
+};
+
+
+/**
+** Sorted keys of a flat_index, in an array of keys.
+*/
+template <typename KeyT, typename KeyCompareT,
+  bool contiguous = flat_key_traits<KeyT, KeyCompareT>::contiguous>
+class flat_key_array
+{
+  public:
+    /// Assigns the keys of a sorted range of map elements
+    template <typename IterT>
+    void assign(IterT beg, IterT end);
+
+    unsigned int size() const;
+    void clear();
+
+    KeyT key(const unsigned int pos) const;
+
+    /// When not found, returns size()
+    unsigned int find(const KeyCompareT& keyComp, const KeyT& key) const;
+
+  private:
+    std::vector<KeyT> _keys;
+
+    unsigned int lower_bound(const KeyCompareT& keyComp,
+      const KeyT& key) const;
+};
+
+
+/**
+** Sorted string keys of a flat_index, stored back to back in one character
+** array. This takes a fraction of the memory of separate strings. Keys are
+** found through an open addressing hash table, which typically compares
+** one key instead of a key per level of a binary search.
+*/
+template <typename KeyCompareT>
+class flat_key_array<std::string, KeyCompareT, true>
+{
+  public:
+    template <typename IterT>
+    void assign(IterT beg, IterT end);
+
+    unsigned int size() const;
+    void clear();
+
+    std::string key(const unsigned int pos) const;
+
+    unsigned int find(const KeyCompareT& keyComp,
+      const std::string& key) const;
+
+  private:
+    typedef typename flat_key_traits<std::string, KeyCompareT>::hasher
+      tHasher;
+
+    // Hash table slot: the hash of a key and its position plus one. The
+    // position is zero in empty slots.
+    struct tSlot
+    {
+        unsigned int hash;
+        unsigned int pos;
+    };
+
+    std::vector<char> _chars;
+
+    // Start of each key in _chars, followed by the end of the last key
+    std::vector<unsigned int> _offsets;
+
+    // Number of slots is a power of two, at least twice the number of keys
+    std::vector<tSlot> _slots;
+
+    inline int compare(const unsigned int pos, const std::string& key) const;
+};
+
+
+/**
+** Read-optimized index that replaces a std::map once the map is not going to
+** be modified any more. Keys are stored in one contiguous array, sorted with
+** the map's key comparator, and values are stored in a parallel array. String
+** keys of the byte order and case-insensitive comparators are stored as one
+** character array (see flat_key_traits). This avoids a node allocation per
+** element and node-to-node pointer chasing during lookups. The index is built
+** from a map and can be converted back to a map. Values can be changed in
+** place, keys cannot.
+*/
+template <typename KeyT, typename ValueT,
+  typename KeyCompareT = std::less<KeyT> >
+class flat_index
+{
+  public:
+    typedef std::map<KeyT, ValueT, KeyCompareT> tMap;
+
+    flat_index();
+    flat_index(const KeyCompareT& cmp);
+    flat_index(const tMap& inMap);
+
+    /// The map can use any allocator
+    template <typename MapAllocT>
+    void assign(const std::map<KeyT, ValueT, KeyCompareT, MapAllocT>& inMap);
+    template <typename MapAllocT>
+    void to_map(std::map<KeyT, ValueT, KeyCompareT, MapAllocT>& outMap) const;
+
+    unsigned int size() const;
+    bool empty() const;
+    void clear();
+
+    /// When not found, returns size()
+    unsigned int find(const KeyT& key) const;
+
+    KeyT key(const unsigned int pos) const;
+    const ValueT& value(const unsigned int pos) const;
+    ValueT& value(const unsigned int pos);
+
+    KeyCompareT key_comp() const;
+
+  private:
+    KeyCompareT _keyComp;
+
+    flat_key_array<KeyT, KeyCompareT> _keys;
+    std::vector<ValueT> _values;
+};
+
+
+inline int flat_key_bytes_traits::compare(const char* s1,
+  const unsigned int n1, const char* s2, const unsigned int n2)
+{
+    const int res = memcmp(s1, s2, (n1 < n2) ? n1 : n2);
+
+    if (res != 0)
+    {
+        return (res);
+    }
+
+    return ((n1 < n2) ? -1 : ((n1 > n2) ? 1 : 0));
+}
+
+
+inline int flat_key_traits<std::string,
+  StringLessT<Char::eCASE_INSENSITIVE> >::compare(const char* s1,
+  const unsigned int n1, const char* s2, const unsigned int n2)
+{
+    // Same order as StringLessT<Char::eCASE_INSENSITIVE>
+    const unsigned int len = (n1 < n2) ? n1 : n2;
+
+    for (unsigned int i = 0; i < len; ++i)
+    {
+        const char c1 = Char::ToLower(s1[i]);
+        const char c2 = Char::ToLower(s2[i]);
+
+        if (c1 != c2)
+        {
+            return ((c1 < c2) ? -1 : 1);
+        }
+    }
+
+    return ((n1 < n2) ? -1 : ((n1 > n2) ? 1 : 0));
+}
+
+
+#endif
@@ -17,6 +17,82 @@
 #include <vector>
 #include <map>
 
+#include "rcsb_types.h"
+#include "resource_allocator.h"
+#include "flat_index.h"
+
+
+template <typename T, typename StringCompareT, typename AllocT>
+class mapped_ptr_vector;
+
+
+/**
+** Immutable view of a mapped_ptr_vector, as it was when the snapshot was
+** taken. Snapshots are cheap to copy, as all copies share the same data,
+** and they can be used from many threads at the same time without locking.
+** Lookups in a snapshot do not use or update any cache. Objects are not
+** copied, only pointers to them, so objects must outlive all snapshots and
+** must not be modified while snapshots are shared.
+*/
+template <typename T, typename StringCompareT = std::less<std::string> >
+class mapped_ptr_vector_snapshot
+{
+  template <typename U, typename CompareU, typename AllocU>
+  friend class mapped_ptr_vector;
+
+  private:
+    struct tBody
+    {
+        tBody(const StringCompareT& cmp);
+
+        // Number of handles (and containers) that share this body
+        volatile UInt32 refCount;
+
+        std::vector<T*> vector;
+
+        flat_index<std::string, std::pair<unsigned int, unsigned int>,
+          StringCompareT> index;
+    };
+
+    tBody* _body;
+
+    mapped_ptr_vector_snapshot(tBody* body);
+
+    void release();
+
+  public:
+    mapped_ptr_vector_snapshot();
+    mapped_ptr_vector_snapshot(const mapped_ptr_vector_snapshot& inSnapshot);
+    ~mapped_ptr_vector_snapshot();
+
+    void operator=(const mapped_ptr_vector_snapshot& inSnapshot);
+
+    unsigned int size() const;
+    bool empty() const;
+
+    /// Throws InvalidStateException if the object has not been read
+    const T& operator[](unsigned int index) const;
+    const T& operator[](const std::string& name) const;
+
+    // When not found, returns size()
+    unsigned int find(const std::string& name) const;
+
+    /// When not found, returns false. Does not throw.
+    bool try_find(unsigned int& index, const std::string& name) const;
+
+    /// When not found or not de-serialized, returns NULL. Does not throw.
+    const T* try_get(unsigned int index) const;
+    const T* try_get(const std::string& name) const;
+
+    /// Is object de-serialized
+    bool is_read(const std::string& name) const;
+
+    std::pair<unsigned int, unsigned int>
+      get_indices(const std::string& name) const;
+    std::string get_name(const unsigned int index) const;
+};
+
+
 
 /**
 ** This is a container of pointers to objects. The container maintains the
@@ -24,29 +100,53 @@
 ** efficient element access, search, serialization and deserialization.
 ** Object names must be unique, i.e., for any two object names in the container
 ** operator==() must yield false.
+** Containers that are built once and then only searched can be frozen. A
+** frozen container keeps its name index in a flat sorted array instead of
+** a map, which makes lookups faster and uses less memory. Any operation that
+** adds, removes or renames objects thaws the container first.
+** The object pointers and the map index nodes are allocated with AllocT,
+** e.g., with resource_allocator from an arena. The characters of the names
+** in the index, the frozen index and snapshots use the heap.
 */
-template <typename T, typename StringCompareT = std::less<std::string> >
+template <typename T, typename StringCompareT = std::less<std::string>,
+  typename AllocT = std::allocator<T*> >
 class mapped_ptr_vector
 {
   private:
     // The first integer is the index in _vector
     // The second integer is the index in the file
     typedef std::map<std::string, std::pair<unsigned int, unsigned int>,
-      StringCompareT > tIndex;
+      StringCompareT, typename rebind_allocator<AllocT, std::pair<
+      const std::string, std::pair<unsigned int, unsigned int> > >::other>
+      tIndex;
+
+    typedef flat_index<std::string, std::pair<unsigned int, unsigned int>,
+      StringCompareT> tFrozenIndex;
 
     tIndex _index;
+    tFrozenIndex _frozenIndex;
+    bool _frozen;
 
-    std::vector<T*> _vector;
+    std::vector<T*, AllocT> _vector;
 
     std::string _currentName;
     std::pair<unsigned int, unsigned int> _currentIndices;
 
+    // Data of the last taken snapshot, shared with its handles. Released as
+    // soon as the container is modified, so that the next snapshot gets a
+    // new copy while existing handles keep the old one.
+    typename mapped_ptr_vector_snapshot<T, StringCompareT>::tBody*
+      _snapshotBody;
+
+    void release_snapshot();
+
     bool is_equal(const std::string& first, const std::string& second,
       const typename tIndex::key_compare& keyComp) const;
 
   public:
     mapped_ptr_vector();
     mapped_ptr_vector(const StringCompareT& cmp);
+    mapped_ptr_vector(const StringCompareT& cmp, const AllocT& alloc);
     mapped_ptr_vector(const mapped_ptr_vector& inMappedVector);
     ~mapped_ptr_vector();
 
@@ -67,12 +167,20 @@ class mapped_ptr_vector
     /// Associate the object pointer to already entered object name
     void set(T* inP);
 
+    /// Throws InvalidStateException if the object has not been read
     T& operator[](unsigned int index);
     T& operator[](const std::string& name);
 
     // When not found, returns size()
     unsigned int find(const std::string& name);
 
+    /// When not found, returns false. Does not throw.
+    bool try_find(unsigned int& index, const std::string& name);
+
+    /// When not found or not de-serialized, returns NULL. Does not throw.
+    T* try_get(unsigned int index);
+    T* try_get(const std::string& name);
+
     void rename(const std::string& oldName, const std::string& newName);
 
     /// Removes object pointer
@@ -90,6 +198,17 @@ class mapped_ptr_vector
     std::pair<unsigned int, unsigned int> get_indices(const std::string& name);
     std::string get_name(const unsigned int index);
     void get_sorted_indices(std::vector<unsigned int>& sortedIndices);
+
+    /// Converts the name index to the read-optimized form
+    void freeze();
+
+    /// Converts the name index back to the modifiable form
+    void thaw();
+
+    bool is_frozen() const;
+
+    /// Returns an immutable snapshot that can be shared between threads
+    mapped_ptr_vector_snapshot<T, StringCompareT> snapshot();
 };
 
 
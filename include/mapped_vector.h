@@ -11,21 +11,38 @@
 #include <vector>
 #include <map>
 
+#include "resource_allocator.h"
+#include "flat_index.h"
+
 
 /**
 ** Container of objects that maintans their order (as vector does), but
 ** provides for fast searching. Objects must be unique, i.e., for any two
 ** objects in the container operator==() must yield false.
+** Containers that are not modified any more can be frozen, which replaces
+** the map index with a flat sorted array. Modifying a frozen container thaws
+** it first.
+** The objects and the map index nodes are allocated with AllocT, e.g., with
+** resource_allocator from an arena. Memory that the objects allocate
+** themselves, e.g., the characters of strings, and the frozen index use the
+** heap.
 */
-template <typename T, typename StringCompareT = std::less<T> >
+template <typename T, typename StringCompareT = std::less<T>,
+  typename AllocT = std::allocator<T> >
 class mapped_vector
 {
   private:
-    typedef std::map<T, unsigned int, StringCompareT> tIndex;
+    typedef std::map<T, unsigned int, StringCompareT,
+      typename rebind_allocator<AllocT, std::pair<const T,
+      unsigned int> >::other> tIndex;
+
+    typedef flat_index<T, unsigned int, StringCompareT> tFrozenIndex;
 
     tIndex _index;
+    tFrozenIndex _frozenIndex;
+    bool _frozen;
 
-    std::vector<T> _vector;
+    std::vector<T, AllocT> _vector;
 
     mutable std::pair<T, unsigned int> _current;
 
@@ -36,6 +53,7 @@ class mapped_vector
   public:
     mapped_vector();
     mapped_vector(const StringCompareT& cmp);
+    mapped_vector(const StringCompareT& cmp, const AllocT& alloc);
     mapped_vector(const mapped_vector& inMappedVector);
     ~mapped_vector();
 
@@ -49,8 +67,11 @@ class mapped_vector
     bool operator!=(const mapped_vector& inMappedVector);
 
     const T& operator[](unsigned int index) const;
-    const std::vector<T>& get_vector() const;
-    std::vector<T>& get_vector();
+
+    /// When the index is invalid, returns NULL. Does not throw.
+    const T* try_get(unsigned int index) const;
+    const std::vector<T, AllocT>& get_vector() const;
+    std::vector<T, AllocT>& get_vector();
 
     void erase(const T& inT);
     void insert(const unsigned int index, const T& inT);
@@ -60,6 +81,17 @@ class mapped_vector
 
     /// When not found, returns size()
     unsigned int find(const T& inT) const;
+
+    /// When not found, returns false. Does not throw.
+    bool try_find(unsigned int& index, const T& inT) const;
+
+    /// Converts the index to the read-optimized form
+    void freeze();
+
+    /// Converts the index back to the modifiable form
+    void thaw();
+
+    bool is_frozen() const;
 };
 
 
@@ -13,6 +13,8 @@ typedef short int SInt16;
 typedef unsigned short int UInt16;
 typedef int SInt32;
 typedef unsigned int UInt32;
+typedef long long SInt64;
+typedef unsigned long long UInt64;
 
 // Basic types sizes in octets
 const UInt8 UINT32_SIZE = sizeof(UInt32);
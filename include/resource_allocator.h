@@ -0,0 +1,99 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file resource_allocator.h
+*/
+
+
+#ifndef RESOURCE_ALLOCATOR_H
+#define RESOURCE_ALLOCATOR_H
+
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "RcsbMemory.h"
+
+
+/**
+** Standard library allocator that allocates from an RcsbMemoryResource,
+** e.g., an RcsbArena. The default resource is the global heap. Containers
+** copy the allocator, so the resource must outlive all containers that
+** use it. Allocators are equal if their resources are equal.
+*/
+template <typename T>
+class resource_allocator
+{
+  public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef resource_allocator<U> other;
+    };
+
+    resource_allocator();
+    resource_allocator(RcsbMemoryResource* resource);
+    resource_allocator(const resource_allocator& inAllocator);
+    template <typename U>
+    resource_allocator(const resource_allocator<U>& inAllocator);
+    ~resource_allocator();
+
+    pointer address(reference x) const;
+    const_pointer address(const_reference x) const;
+
+    pointer allocate(size_type n, const void* hint = 0);
+    void deallocate(pointer p, size_type n);
+
+    size_type max_size() const;
+
+    void construct(pointer p, const T& val);
+    void destroy(pointer p);
+
+    RcsbMemoryResource* resource() const;
+
+  private:
+    RcsbMemoryResource* _resource;
+};
+
+
+/**
+** Allocator of U of the same kind as AllocT, for containers that allocate
+** other types than their elements. C++20 removed rebind from
+** std::allocator, so allocator_traits is used where it exists.
+*/
+template <typename AllocT, typename U>
+struct rebind_allocator
+{
+#if __cplusplus >= 201103L
+    typedef typename std::allocator_traits<AllocT>::template
+      rebind_alloc<U> other;
+#else
+    typedef typename AllocT::template rebind<U>::other other;
+#endif
+};
+
+
+template <typename T, typename U>
+bool operator==(const resource_allocator<T>& first,
+  const resource_allocator<U>& second);
+
+template <typename T, typename U>
+bool operator!=(const resource_allocator<T>& first,
+  const resource_allocator<U>& second);
+
+
+#endif
+